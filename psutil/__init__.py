@@ -389,6 +389,9 @@ class Process(object):
         self._proc = _psplatform.Process(pid)
         self._last_sys_cpu_times = None
         self._last_proc_cpu_times = None
+        # set by spawn() on Linux; refers to this very process even
+        # after its PID has been reused
+        self._pidfd = None
         # cache creation time for later use in is_running() method
         try:
             self.create_time()
@@ -1115,7 +1118,10 @@ class Process(object):
                     "would affect every process in the process group of the "
                     "calling process (os.getpid()) instead of PID 0")
             try:
-                os.kill(self.pid, sig)
+                if self._pidfd is not None:
+                    _psplatform.pidfd_send_signal(self._pidfd, sig)
+                else:
+                    os.kill(self.pid, sig)
             except OSError as err:
                 if err.errno == errno.ESRCH:
                     if OPENBSD and pid_exists(self.pid):
@@ -1193,6 +1199,61 @@ class Process(object):
         else:  # pragma: no cover
             self._proc.kill()
 
+    def send_signal_tree(self, sig, timeout=0, include_self=True,
+                         callback=None):
+        """Send a signal to this process and all its descendants,
+        then wait_procs() for them for up to 'timeout' seconds.
+        Return a (gone, alive) tuple like wait_procs(); processes
+        which could not be signaled (e.g. because of insufficient
+        permissions) are returned as alive.
+
+        Process identity is verified once per process right before
+        signaling it and, where supported (Linux >= 5.3), signals are
+        sent through a pidfd so that a reused PID is never hit.
+        Parents are signaled before their children so that they
+        can't spawn new ones in the meantime.
+        """
+        if timeout is not None and not timeout >= 0:
+            raise ValueError("timeout must be a positive integer")
+        procs = self.children(recursive=True)
+        if include_self:
+            if self.pid == os.getpid():
+                procs.append(self)
+            else:
+                procs.insert(0, self)
+        gone = []
+        if hasattr(_psplatform, "send_signal_many"):
+            errnos = _psplatform.send_signal_many(
+                [(p.pid, p._create_time) for p in procs], sig)
+            for proc, err in zip(procs, errnos):
+                if err == errno.ESRCH:
+                    proc._gone = True
+                    gone.append(proc)
+        else:
+            for proc in procs:
+                try:
+                    proc.send_signal(sig)
+                except NoSuchProcess:
+                    gone.append(proc)
+                except AccessDenied:
+                    pass
+        for proc in gone:
+            proc.returncode = None
+            if callback is not None:
+                callback(proc)
+        procs = [x for x in procs if x not in gone]
+        _gone, alive = wait_procs(procs, timeout=timeout, callback=callback)
+        return (gone + _gone, alive)
+
+    def kill_tree(self, timeout=0, include_self=True, callback=None):
+        """Kill this process and all its descendants with SIGKILL.
+        See send_signal_tree().
+        """
+        sig = signal.SIGKILL if POSIX else signal.SIGTERM
+        return self.send_signal_tree(sig, timeout=timeout,
+                                     include_self=include_self,
+                                     callback=callback)
+
     def wait(self, timeout=None):
         """Wait for process to terminate and, if process is a children
         of os.getpid(), also return its exit code, else None.
@@ -1207,6 +1268,13 @@ class Process(object):
         """
         if timeout is not None and not timeout >= 0:
             raise ValueError("timeout must be a positive integer")
+        if self._pidfd is not None:
+            if not _psplatform.pidfd_wait(self._pidfd, timeout):
+                raise TimeoutExpired(timeout, self.pid, self._name)
+            ret = self._proc.wait()
+            os.close(self._pidfd)
+            self._pidfd = None
+            return ret
         return self._proc.wait(timeout)
 
 
@@ -1246,16 +1314,36 @@ class Popen(Process):
     you don't accidentally terminate another process, fixing
     http://bugs.python.org/issue6973.
 
+    If 'reaper' is True (Linux >= 5.3 only, ignored elsewhere) the
+    child exit status is collected by a process-wide reaper thread
+    which watches all such children at once, and wait() blocks on a
+    condition instead of polling. returncode follows subprocess.Popen
+    semantics (negative signal number if the child was killed).
+
     For a complete documentation refer to:
     http://docs.python.org/library/subprocess.html
     """
 
     def __init__(self, *args, **kwargs):
+        reaper = kwargs.pop('reaper', False)
         # Explicitly avoid to raise NoSuchProcess in case the process
         # spawned by subprocess.Popen terminates too quickly, see:
         # https://github.com/giampaolo/psutil/issues/193
         self.__subproc = subprocess.Popen(*args, **kwargs)
         self._init(self.__subproc.pid, _ignore_nsp=True)
+        self.__reaper = None
+        if reaper and hasattr(_psplatform, "get_child_reaper"):
+            _reaper = _psplatform.get_child_reaper()
+            try:
+                # The actual waitpid() is left to subprocess.Popen.poll()
+                # so that its own bookkeeping stays consistent.
+                _reaper.register(self.pid, self.__subproc.poll)
+            except OSError as err:
+                if err.errno != errno.ENOSYS:
+                    raise
+                # kernel < 5.3: fall back on polling
+            else:
+                self.__reaper = _reaper
 
     def __dir__(self):
         return sorted(set(dir(Popen) + dir(subprocess.Popen)))
@@ -1273,10 +1361,69 @@ class Popen(Process):
     def wait(self, timeout=None):
         if self.__subproc.returncode is not None:
             return self.__subproc.returncode
+        if self.__reaper is not None:
+            return self.__wait_reaped(timeout)
         ret = super(Popen, self).wait(timeout)
         self.__subproc.returncode = ret
         return ret
 
+    def __wait_reaped(self, timeout):
+        if timeout is not None:
+            if not timeout >= 0:
+                raise ValueError("timeout must be a positive integer")
+            stop_at = _timer() + timeout
+        cond = self.__reaper.cond
+        with cond:
+            while self.__subproc.returncode is None:
+                if timeout is None:
+                    cond.wait()
+                else:
+                    remaining = stop_at - _timer()
+                    if remaining <= 0:
+                        raise TimeoutExpired(timeout, self.pid, self._name)
+                    cond.wait(remaining)
+        return self.__subproc.returncode
+
+
+if hasattr(_psplatform, "spawn"):
+
+    def spawn(args, env=None, cwd=None, stdin=None, stdout=None,
+              stderr=None, cgroup=None, cpu_affinity=None, rlimits=None,
+              ionice=None, nice=None):
+        """Start a new program and return a Process instance for it.
+
+        Unlike Popen the child is created vfork()-style (no copy of
+        the parent memory) and the following are applied before the
+        new program is executed, so it never runs unconstrained:
+
+         - cgroup: path of a cgroup directory to move the child in
+         - cpu_affinity: a list of CPUs (see Process.cpu_affinity())
+         - rlimits: a {RLIMIT_*: (soft, hard)} dict
+         - ionice: an (ioclass, value) tuple (see Process.ionice())
+         - nice: the niceness (see Process.nice())
+
+        stdin, stdout and stderr are file objects or file descriptors.
+        On Linux >= 5.2 the returned process is tracked through a
+        pidfd, so send_signal(), terminate() and kill() can't hit
+        another process even if its PID got reused, and wait()
+        doesn't poll.
+        Raise OSError if the child could not be set up or executed.
+        """
+        pid, pidfd = _psplatform.spawn(
+            args, env=env, cwd=cwd, stdin=stdin, stdout=stdout,
+            stderr=stderr, cgroup=cgroup, cpu_affinity=cpu_affinity,
+            rlimits=rlimits, ionice=ionice, nice=nice)
+        proc = Process.__new__(Process)
+        proc._init(pid, _ignore_nsp=True)
+        if pidfd != -1:
+            if hasattr(_psplatform, "pidfd_wait"):
+                proc._pidfd = pidfd
+            else:
+                os.close(pidfd)
+        return proc
+
+    __all__.append("spawn")
+
 
 # =====================================================================
 # --- system processes related functions
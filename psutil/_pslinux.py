@@ -11,9 +11,12 @@ import errno
 import functools
 import os
 import re
+import select
 import socket
 import struct
 import sys
+import threading
+import time
 import traceback
 import warnings
 from collections import defaultdict
@@ -36,6 +39,7 @@ from ._compat import b
 from ._compat import basestring
 from ._compat import long
 from ._compat import PY3
+from ._compat import which
 
 if sys.version_info >= (3, 4):
     import enum
@@ -74,6 +78,7 @@ BOOT_TIME = None  # set later
 # speedup, see: https://github.com/giampaolo/psutil/issues/708
 BIGGER_FILE_BUFFERING = -1 if PY3 else 8192
 LITTLE_ENDIAN = sys.byteorder == 'little'
+_timer = getattr(time, 'monotonic', time.time)
 if PY3:
     FS_ENCODING = sys.getfilesystemencoding()
     ENCODING_ERRORS_HANDLER = 'surrogateescape'
@@ -516,6 +521,235 @@ def pid_exists(pid):
     return _psposix.pid_exists(pid)
 
 
+if hasattr(cext, "proc_pidfd_open"):
+
+    class ChildReaper(object):
+        """Collects the exit status of child processes in one place.
+
+        Every registered child is tracked through a pidfd, which
+        becomes readable as soon as the child terminates. A single
+        daemon thread poll()s all of them and invokes the callback
+        associated with the child which exited, then wakes up
+        whoever is blocked on 'cond'.
+        This replaces one waitpid() busy-loop per child with one
+        poll() call for all children.
+        """
+
+        def __init__(self):
+            self.cond = threading.Condition()
+            self._pid = os.getpid()
+            self._lock = threading.Lock()
+            self._callbacks = {}
+            self._pending = []
+            self._rfd, self._wfd = os.pipe()
+            self._poller = select.poll()
+            self._poller.register(self._rfd, select.POLLIN)
+            self._thread = None
+
+        def register(self, pid, callback):
+            """Call 'callback' (from the reaper thread) once 'pid'
+            terminates. Raise OSError(ENOSYS) if pidfd_open() is not
+            supported by the running kernel.
+            """
+            try:
+                fd = cext.proc_pidfd_open(pid)
+            except OSError as err:
+                if err.errno == errno.ESRCH:
+                    # already gone and reaped by somebody else
+                    self._notify(callback)
+                    return
+                raise
+            with self._lock:
+                self._callbacks[fd] = callback
+                self._pending.append(fd)
+                if self._thread is None:
+                    self._thread = threading.Thread(
+                        target=self._run, name="psutil-child-reaper")
+                    self._thread.daemon = True
+                    self._thread.start()
+            # wake up poll() so that the new fd gets registered
+            os.write(self._wfd, b"x")
+
+        def _notify(self, callback):
+            try:
+                callback()
+            finally:
+                with self.cond:
+                    self.cond.notify_all()
+
+        def _run(self):
+            while True:
+                try:
+                    events = self._poller.poll()
+                except (select.error, OSError) as err:
+                    if err.args[0] == errno.EINTR:
+                        continue
+                    raise
+                for fd, _ in events:
+                    if fd == self._rfd:
+                        os.read(self._rfd, 4096)
+                        with self._lock:
+                            pending, self._pending = self._pending, []
+                        for pfd in pending:
+                            self._poller.register(pfd, select.POLLIN)
+                    else:
+                        self._poller.unregister(fd)
+                        os.close(fd)
+                        with self._lock:
+                            callback = self._callbacks.pop(fd)
+                        self._notify(callback)
+
+    _child_reaper = None
+    _child_reaper_lock = threading.Lock()
+
+    def get_child_reaper():
+        """Return the process-wide ChildReaper instance."""
+        global _child_reaper
+        with _child_reaper_lock:
+            # a forked child does not inherit the reaper thread
+            if _child_reaper is None or _child_reaper._pid != os.getpid():
+                _child_reaper = ChildReaper()
+            return _child_reaper
+
+
+def send_signal_many(procs, sig):
+    """Send 'sig' to many processes in one go. 'procs' is a list of
+    (pid, create_time) tuples; create_time is used to make sure the
+    PID was not reused (None skips the check).
+    Return a list of errno values (0 = success), one per process.
+    """
+    bt = BOOT_TIME or boot_time()
+    args = []
+    for pid, create_time in procs:
+        if create_time is None:
+            starttime = -1
+        else:
+            # reverse what Process.create_time() does
+            starttime = int(round((create_time - bt) * CLOCK_TICKS))
+        args.append((pid, starttime))
+    return cext.proc_send_signal_many(get_procfs_path(), args, sig)
+
+
+def spawn(args, env=None, cwd=None, stdin=None, stdout=None, stderr=None,
+          cgroup=None, cpu_affinity=None, rlimits=None, ionice=None,
+          nice=None):
+    """Start a new process with cgroup, CPU affinity, resource limits,
+    I/O priority and niceness applied before it exec()s.
+    Return a (pid, pidfd) tuple; pidfd is -1 on Linux < 5.2.
+    """
+    if isinstance(args, basestring):
+        args = [args]
+    args = list(args)
+    if not args:
+        raise ValueError("args must not be empty")
+    if env is not None:
+        path = env.get("PATH", os.defpath)
+    else:
+        path = None
+    exe = which(args[0], path=path)
+    if exe is None:
+        raise OSError(errno.ENOENT, "no such file or directory: %r"
+                      % args[0])
+    if cwd is not None:
+        cwd = os.path.abspath(cwd)
+        if not os.path.isabs(exe):
+            exe = os.path.abspath(exe)
+        cwd = _fsencode(cwd)
+    argv = [_fsencode(x) for x in args]
+    if env is not None:
+        env = [_fsencode(k) + b"=" + _fsencode(v) for k, v in env.items()]
+
+    fds = []
+    for f in (stdin, stdout, stderr):
+        if f is None:
+            fds.append(-1)
+        elif isinstance(f, (int, long)):
+            fds.append(f)
+        else:
+            fds.append(f.fileno())
+
+    if ionice is not None:
+        ioclass, iodata = ionice
+        if ioclass in (IOPRIO_CLASS_RT, IOPRIO_CLASS_BE):
+            if iodata is None:
+                iodata = 4
+            if not 0 <= iodata <= 7:
+                raise ValueError(
+                    "value argument range expected is between 0 and 7")
+        elif ioclass in (IOPRIO_CLASS_NONE, IOPRIO_CLASS_IDLE):
+            if iodata:
+                raise ValueError("can't specify value with ioclass %r "
+                                 "(got %r)" % (ioclass, iodata))
+            iodata = 0
+        else:
+            raise ValueError("invalid ioclass argument %r" % ioclass)
+        ioclass = int(ioclass)
+    else:
+        ioclass, iodata = -1, 0
+
+    limits = []
+    for resource, value in (rlimits or {}).items():
+        if len(value) != 2:
+            raise ValueError("rlimits values must be (soft, hard) tuples, "
+                             "got %r" % (value, ))
+        limits.append((resource, value[0], value[1]))
+    if cpu_affinity is not None:
+        cpu_affinity = list(cpu_affinity)
+        if not cpu_affinity:
+            raise ValueError("invalid empty CPU affinity list")
+
+    cgroup_fd = -1
+    if cgroup is not None:
+        cgroup_fd = os.open(os.path.join(cgroup, "cgroup.procs"),
+                            os.O_WRONLY | getattr(os, "O_CLOEXEC", 0))
+    try:
+        return cext.linux_spawn(
+            _fsencode(exe), argv, env, cwd, fds[0], fds[1], fds[2],
+            cgroup_fd, cpu_affinity, limits, ioclass, iodata,
+            nice is not None, nice or 0)
+    finally:
+        if cgroup_fd != -1:
+            os.close(cgroup_fd)
+
+
+def _fsencode(s):
+    if isinstance(s, bytes):
+        return s
+    if PY3:
+        return os.fsencode(s)
+    return s.encode(sys.getfilesystemencoding())
+
+
+if hasattr(cext, "proc_pidfd_send_signal"):
+
+    def pidfd_send_signal(pidfd, sig):
+        """Send a signal to the process referred to by 'pidfd'."""
+        cext.proc_pidfd_send_signal(pidfd, sig)
+
+    def pidfd_wait(pidfd, timeout=None):
+        """Wait until the process referred to by 'pidfd' terminates.
+        Return False if timeout expired first.
+        """
+        poller = select.poll()
+        poller.register(pidfd, select.POLLIN)
+        if timeout is not None:
+            stop_at = _timer() + timeout
+        while True:
+            if timeout is None:
+                ms = None
+            else:
+                ms = max(0, int((stop_at - _timer()) * 1000) + 1)
+            try:
+                if poller.poll(ms):
+                    return True
+            except (select.error, OSError) as err:
+                if err.args[0] == errno.EINTR:
+                    continue
+                raise
+            if timeout is not None and _timer() >= stop_at:
+                return False
+
+
 # --- network
 
 class _Ipv6UnsupportedError(Exception):
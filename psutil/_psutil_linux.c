@@ -16,9 +16,15 @@
 #include <features.h>
 #include <utmp.h>
 #include <sched.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <linux/version.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/syscall.h>
 #include <sys/sysinfo.h>
+#include <sys/wait.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <linux/sockios.h>
@@ -48,6 +54,13 @@ static const int NCPUS_START = sizeof(unsigned long) * CHAR_BIT;
     (__GLIBC__ >= 2 && __GLIBC_MINOR__ >= 13) && \
     defined(__NR_prlimit64)
 
+// Linux >= 5.3
+#define PSUTIL_HAVE_PIDFD \
+    defined(__NR_pidfd_open) && defined(__NR_pidfd_send_signal)
+
+// Stack used by the child of psutil_linux_spawn() until it exec()s.
+#define PSUTIL_SPAWN_STACK_SIZE (256 * 1024)
+
 #if PSUTIL_HAVE_PRLIMIT
     #define _FILE_OFFSET_BITS 64
     #include <time.h>
@@ -125,6 +138,548 @@ psutil_proc_ioprio_set(PyObject *self, PyObject *args) {
 #endif
 
 
+#if PSUTIL_HAVE_PIDFD
+/*
+ * A wrapper around pidfd_open(2); return a file descriptor referring
+ * to the process. The fd becomes readable when the process exits and,
+ * unlike the PID, it can never refer to another process.
+ */
+static PyObject *
+psutil_proc_pidfd_open(PyObject *self, PyObject *args) {
+    long pid;
+    int fd;
+
+    if (! PyArg_ParseTuple(args, "l", &pid))
+        return NULL;
+    fd = syscall(__NR_pidfd_open, (pid_t)pid, 0);
+    if (fd == -1)
+        return PyErr_SetFromErrno(PyExc_OSError);
+    return Py_BuildValue("i", fd);
+}
+
+
+/*
+ * A wrapper around pidfd_send_signal(2). Unlike kill(2) the signal
+ * can't be delivered to another process in case the PID got reused.
+ */
+static PyObject *
+psutil_proc_pidfd_send_signal(PyObject *self, PyObject *args) {
+    int fd;
+    int sig;
+
+    if (! PyArg_ParseTuple(args, "ii", &fd, &sig))
+        return NULL;
+    if (syscall(__NR_pidfd_send_signal, fd, sig, NULL, 0) == -1)
+        return PyErr_SetFromErrno(PyExc_OSError);
+    Py_RETURN_NONE;
+}
+#endif
+
+
+/*
+ * Read the start time (in clock ticks since boot) of a process from
+ * /proc/[pid]/stat. Return -1 and set errno on failure.
+ */
+static long long
+psutil_proc_starttime(const char *procfs_path, pid_t pid) {
+    char path[PATH_MAX];
+    char buf[1024];
+    char *p;
+    ssize_t n;
+    int fd;
+    int field;
+
+    snprintf(path, sizeof(path), "%s/%d/stat", procfs_path, (int)pid);
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+        return -1;
+    n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (n <= 0) {
+        errno = n == 0 ? ESRCH : errno;
+        return -1;
+    }
+    buf[n] = '\0';
+    // skip "pid (comm)", comm may contain spaces and parentheses
+    p = strrchr(buf, ')');
+    if (p == NULL) {
+        errno = EINVAL;
+        return -1;
+    }
+    // starttime is the 22nd field, the 20th one after comm
+    for (field = 0; field < 20; field++) {
+        p = strchr(p + 1, ' ');
+        if (p == NULL) {
+            errno = EINVAL;
+            return -1;
+        }
+    }
+    return strtoll(p + 1, NULL, 10);
+}
+
+
+/*
+ * Send a signal to many processes at once. Takes a sequence of
+ * (pid, starttime) tuples where starttime is the process start time
+ * in clock ticks as read from /proc/[pid]/stat (or -1 to skip the
+ * check). Every process is pinned through a pidfd (if supported)
+ * before its identity is verified so that the PID can't be reused
+ * in between. Return a list of errno values, one per process, 0
+ * meaning success; a process whose identity doesn't match gets ESRCH.
+ */
+static PyObject *
+psutil_proc_send_signal_many(PyObject *self, PyObject *args) {
+    char *procfs_path;
+    PyObject *py_procs;
+    PyObject *py_seq = NULL;
+    PyObject *py_retlist = NULL;
+    PyObject *py_errno = NULL;
+    Py_ssize_t i;
+    Py_ssize_t len;
+    pid_t *pids = NULL;
+    long long *starttimes = NULL;
+    int *errnos = NULL;
+    int sig;
+    int fd;
+    int ret;
+    long pid;
+    int have_pidfd = 1;
+
+    if (! PyArg_ParseTuple(args, "sOi", &procfs_path, &py_procs, &sig))
+        return NULL;
+    py_seq = PySequence_Fast(py_procs, "expected a sequence");
+    if (py_seq == NULL)
+        return NULL;
+    len = PySequence_Fast_GET_SIZE(py_seq);
+    pids = PyMem_Malloc((len + 1) * sizeof(pid_t));
+    starttimes = PyMem_Malloc((len + 1) * sizeof(long long));
+    errnos = PyMem_Malloc((len + 1) * sizeof(int));
+    if (pids == NULL || starttimes == NULL || errnos == NULL) {
+        PyErr_NoMemory();
+        goto error;
+    }
+    for (i = 0; i < len; i++) {
+        if (! PyArg_ParseTuple(PySequence_Fast_GET_ITEM(py_seq, i), "lL",
+                               &pid, &starttimes[i]))
+            goto error;
+        if (pid <= 0) {
+            // see "man 2 kill"
+            PyErr_Format(PyExc_ValueError, "invalid PID %ld", pid);
+            goto error;
+        }
+        pids[i] = (pid_t)pid;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    for (i = 0; i < len; i++) {
+        fd = -1;
+#if PSUTIL_HAVE_PIDFD
+        if (have_pidfd) {
+            fd = syscall(__NR_pidfd_open, pids[i], 0);
+            if (fd == -1 && errno == ENOSYS) {
+                have_pidfd = 0;
+            }
+            else if (fd == -1) {
+                errnos[i] = errno;
+                continue;
+            }
+        }
+#else
+        have_pidfd = 0;
+#endif
+        if (starttimes[i] != -1 &&
+                psutil_proc_starttime(procfs_path, pids[i]) != starttimes[i])
+        {
+            // gone or PID reused
+            errnos[i] = ESRCH;
+            if (fd != -1)
+                close(fd);
+            continue;
+        }
+#if PSUTIL_HAVE_PIDFD
+        if (fd != -1) {
+            ret = syscall(__NR_pidfd_send_signal, fd, sig, NULL, 0);
+            errnos[i] = ret == -1 ? errno : 0;
+            close(fd);
+            continue;
+        }
+#endif
+        ret = kill(pids[i], sig);
+        errnos[i] = ret == -1 ? errno : 0;
+    }
+    Py_END_ALLOW_THREADS
+
+    py_retlist = PyList_New(len);
+    if (py_retlist == NULL)
+        goto error;
+    for (i = 0; i < len; i++) {
+        py_errno = Py_BuildValue("i", errnos[i]);
+        if (py_errno == NULL)
+            goto error;
+        PyList_SET_ITEM(py_retlist, i, py_errno);
+    }
+    PyMem_Free(pids);
+    PyMem_Free(starttimes);
+    PyMem_Free(errnos);
+    Py_DECREF(py_seq);
+    return py_retlist;
+
+error:
+    Py_XDECREF(py_retlist);
+    PyMem_Free(pids);
+    PyMem_Free(starttimes);
+    PyMem_Free(errnos);
+    Py_DECREF(py_seq);
+    return NULL;
+}
+
+
+/*
+ * Everything psutil_spawn_child() needs, converted from Python objects
+ * before clone() so that the child never touches the interpreter.
+ */
+struct psutil_spawn_args {
+    const char *path;
+    char **argv;
+    char **envp;
+    const char *cwd;
+    int fds[3];
+    int cgroup_fd;
+    cpu_set_t *cpus;
+    size_t cpus_size;
+    int nrlimits;
+    int *rlim_resources;
+    struct rlimit *rlims;
+    int ioprio;
+    int set_nice;
+    int nice;
+    sigset_t oldmask;
+    // written by the child, read by the parent (shared memory)
+    int err;
+};
+
+
+/*
+ * Runs in the child, sharing memory with the (suspended) parent, on
+ * its own stack. Only async-signal-safe calls are allowed in here.
+ * Resource constraints are applied *before* execve() so the program
+ * never runs unconstrained.
+ */
+static int
+psutil_spawn_child(void *arg) {
+    struct psutil_spawn_args *a = (struct psutil_spawn_args *)arg;
+    struct sigaction sa;
+    struct sigaction cur;
+    char buf[32];
+    char *p;
+    long pid;
+    int i;
+    int sig;
+
+    // Handlers installed by the parent (e.g. Python's own) must not
+    // run in here; also restore those Python sets to SIG_IGN, same as
+    // subprocess' restore_signals.
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = SIG_DFL;
+    for (sig = 1; sig < _NSIG; sig++) {
+        if (sigaction(sig, NULL, &cur) != 0)
+            continue;
+        if (cur.sa_handler != SIG_IGN || sig == SIGPIPE || sig == SIGXFSZ)
+            sigaction(sig, &sa, NULL);
+    }
+
+    if (a->cgroup_fd != -1) {
+        // write(cgroup.procs, getpid())
+        pid = syscall(SYS_getpid);
+        p = buf + sizeof(buf);
+        do {
+            *--p = '0' + (pid % 10);
+            pid /= 10;
+        } while (pid > 0);
+        if (write(a->cgroup_fd, p, buf + sizeof(buf) - p) == -1)
+            goto error;
+    }
+    if (a->cpus != NULL) {
+        if (sched_setaffinity(0, a->cpus_size, a->cpus) == -1)
+            goto error;
+    }
+    for (i = 0; i < a->nrlimits; i++) {
+        if (setrlimit(a->rlim_resources[i], &a->rlims[i]) == -1)
+            goto error;
+    }
+#if PSUTIL_HAVE_IOPRIO
+    if (a->ioprio != -1) {
+        if (ioprio_set(IOPRIO_WHO_PROCESS, 0, a->ioprio) == -1)
+            goto error;
+    }
+#endif
+    if (a->set_nice) {
+        if (setpriority(PRIO_PROCESS, 0, a->nice) == -1)
+            goto error;
+    }
+    if (a->cwd != NULL) {
+        if (chdir(a->cwd) == -1)
+            goto error;
+    }
+    for (i = 0; i < 3; i++) {
+        if (a->fds[i] == -1)
+            continue;
+        if (a->fds[i] == i) {
+            // keep it open across exec
+            if (fcntl(i, F_SETFD, 0) == -1)
+                goto error;
+        }
+        else if (dup2(a->fds[i], i) == -1) {
+            goto error;
+        }
+    }
+
+    sigprocmask(SIG_SETMASK, &a->oldmask, NULL);
+    if (a->envp != NULL)
+        execve(a->path, a->argv, a->envp);
+    else
+        execv(a->path, a->argv);
+
+error:
+    a->err = errno;
+    _exit(127);
+}
+
+
+/*
+ * Convert a sequence of bytes into a NULL terminated char* array.
+ * The strings are borrowed from 'py_seq', which must be kept alive.
+ */
+static char **
+psutil_seq_to_strarray(PyObject *py_seq) {
+    Py_ssize_t i;
+    Py_ssize_t len = PySequence_Fast_GET_SIZE(py_seq);
+    char **ret = PyMem_Malloc((len + 1) * sizeof(char *));
+
+    if (ret == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    for (i = 0; i < len; i++) {
+        ret[i] = PyBytes_AsString(PySequence_Fast_GET_ITEM(py_seq, i));
+        if (ret[i] == NULL) {
+            PyMem_Free(ret);
+            return NULL;
+        }
+    }
+    ret[len] = NULL;
+    return ret;
+}
+
+
+/*
+ * Spawn a new process vfork()-style: the child shares the parent
+ * memory (no page tables copy, which is what makes fork() slow for
+ * big parents) and runs on a private stack until it execve()s.
+ * cgroup membership, CPU affinity, resource limits, I/O priority and
+ * niceness are applied in the child before execve().
+ * Return a (pid, pidfd) tuple; pidfd is -1 on kernels < 5.2.
+ */
+static PyObject *
+psutil_linux_spawn(PyObject *self, PyObject *args) {
+    struct psutil_spawn_args a;
+    PyObject *py_argv;
+    PyObject *py_envp;
+    PyObject *py_cwd;
+    PyObject *py_cpus;
+    PyObject *py_rlimits;
+    PyObject *py_argv_seq = NULL;
+    PyObject *py_envp_seq = NULL;
+    PyObject *py_cpus_seq = NULL;
+    PyObject *py_rlimits_seq = NULL;
+    PyObject *py_item;
+    Py_ssize_t i;
+    Py_ssize_t len;
+    long value;
+    long maxcpu;
+    int ioclass;
+    int iodata;
+    int flags;
+    int pid = -1;
+    int pidfd = -1;
+    int saved_errno;
+    char *stack = NULL;
+    sigset_t allsigs;
+
+    memset(&a, 0, sizeof(a));
+    a.ioprio = -1;
+#if PY_MAJOR_VERSION >= 3
+    if (! PyArg_ParseTuple(args, "yOOOiiiiOOiiii",
+#else
+    if (! PyArg_ParseTuple(args, "sOOOiiiiOOiiii",
+#endif
+                           &a.path, &py_argv, &py_envp, &py_cwd,
+                           &a.fds[0], &a.fds[1], &a.fds[2], &a.cgroup_fd,
+                           &py_cpus, &py_rlimits, &ioclass, &iodata,
+                           &a.set_nice, &a.nice))
+        return NULL;
+    if (py_cwd != Py_None) {
+        a.cwd = PyBytes_AsString(py_cwd);
+        if (a.cwd == NULL)
+            return NULL;
+    }
+
+    py_argv_seq = PySequence_Fast(py_argv, "argv must be a sequence");
+    if (py_argv_seq == NULL)
+        goto error;
+    a.argv = psutil_seq_to_strarray(py_argv_seq);
+    if (a.argv == NULL)
+        goto error;
+    if (py_envp != Py_None) {
+        py_envp_seq = PySequence_Fast(py_envp, "env must be a sequence");
+        if (py_envp_seq == NULL)
+            goto error;
+        a.envp = psutil_seq_to_strarray(py_envp_seq);
+        if (a.envp == NULL)
+            goto error;
+    }
+
+    if (py_cpus != Py_None) {
+        py_cpus_seq = PySequence_Fast(py_cpus, "cpus must be a sequence");
+        if (py_cpus_seq == NULL)
+            goto error;
+        len = PySequence_Fast_GET_SIZE(py_cpus_seq);
+        maxcpu = 0;
+        for (i = 0; i < len; i++) {
+            value = PyLong_AsLong(PySequence_Fast_GET_ITEM(py_cpus_seq, i));
+            if (value == -1 && PyErr_Occurred())
+                goto error;
+            if (value < 0) {
+                PyErr_SetString(PyExc_ValueError, "invalid negative CPU");
+                goto error;
+            }
+            if (value > maxcpu)
+                maxcpu = value;
+        }
+        a.cpus = CPU_ALLOC(maxcpu + 1);
+        if (a.cpus == NULL) {
+            PyErr_NoMemory();
+            goto error;
+        }
+        a.cpus_size = CPU_ALLOC_SIZE(maxcpu + 1);
+        CPU_ZERO_S(a.cpus_size, a.cpus);
+        for (i = 0; i < len; i++) {
+            value = PyLong_AsLong(PySequence_Fast_GET_ITEM(py_cpus_seq, i));
+            CPU_SET_S(value, a.cpus_size, a.cpus);
+        }
+    }
+
+    py_rlimits_seq = PySequence_Fast(py_rlimits, "rlimits must be a sequence");
+    if (py_rlimits_seq == NULL)
+        goto error;
+    a.nrlimits = (int)PySequence_Fast_GET_SIZE(py_rlimits_seq);
+    if (a.nrlimits > 0) {
+        a.rlim_resources = PyMem_Malloc(a.nrlimits * sizeof(int));
+        a.rlims = PyMem_Malloc(a.nrlimits * sizeof(struct rlimit));
+        if (a.rlim_resources == NULL || a.rlims == NULL) {
+            PyErr_NoMemory();
+            goto error;
+        }
+    }
+    for (i = 0; i < a.nrlimits; i++) {
+        PY_LONG_LONG soft;
+        PY_LONG_LONG hard;
+        py_item = PySequence_Fast_GET_ITEM(py_rlimits_seq, i);
+        if (! PyArg_ParseTuple(py_item, "iLL", &a.rlim_resources[i],
+                               &soft, &hard))
+            goto error;
+        a.rlims[i].rlim_cur = (rlim_t)soft;
+        a.rlims[i].rlim_max = (rlim_t)hard;
+    }
+
+    if (ioclass != -1) {
+#if PSUTIL_HAVE_IOPRIO
+        a.ioprio = IOPRIO_PRIO_VALUE(ioclass, iodata);
+#else
+        PyErr_SetString(PyExc_NotImplementedError,
+                        "ioprio_set() not supported");
+        goto error;
+#endif
+    }
+
+    stack = mmap(NULL, PSUTIL_SPAWN_STACK_SIZE, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (stack == MAP_FAILED) {
+        stack = NULL;
+        PyErr_SetFromErrno(PyExc_OSError);
+        goto error;
+    }
+
+    // No signal handler must run in the child while it shares our
+    // memory; the child restores the original mask before execve().
+    sigfillset(&allsigs);
+    flags = CLONE_VM | CLONE_VFORK | SIGCHLD;
+    Py_BEGIN_ALLOW_THREADS
+    pthread_sigmask(SIG_BLOCK, &allsigs, &a.oldmask);
+#ifdef CLONE_PIDFD
+    pid = clone(psutil_spawn_child, stack + PSUTIL_SPAWN_STACK_SIZE,
+                flags | CLONE_PIDFD, &a, &pidfd);
+    if (pid == -1 && errno == EINVAL) {
+        // Linux < 5.2
+        pidfd = -1;
+        pid = clone(psutil_spawn_child, stack + PSUTIL_SPAWN_STACK_SIZE,
+                    flags, &a);
+    }
+#else
+    pid = clone(psutil_spawn_child, stack + PSUTIL_SPAWN_STACK_SIZE,
+                flags, &a);
+#endif
+    saved_errno = errno;
+    pthread_sigmask(SIG_SETMASK, &a.oldmask, NULL);
+    Py_END_ALLOW_THREADS
+
+    if (pid == -1) {
+        errno = saved_errno;
+        PyErr_SetFromErrno(PyExc_OSError);
+        goto error;
+    }
+    if (a.err != 0) {
+        // the child failed before (or at) execve() and _exit()ed
+        Py_BEGIN_ALLOW_THREADS
+        waitpid(pid, NULL, 0);
+        Py_END_ALLOW_THREADS
+        if (pidfd != -1)
+            close(pidfd);
+        errno = a.err;
+        PyErr_SetFromErrno(PyExc_OSError);
+        goto error;
+    }
+
+    munmap(stack, PSUTIL_SPAWN_STACK_SIZE);
+    if (a.cpus != NULL)
+        CPU_FREE(a.cpus);
+    PyMem_Free(a.rlim_resources);
+    PyMem_Free(a.rlims);
+    PyMem_Free(a.argv);
+    PyMem_Free(a.envp);
+    Py_DECREF(py_argv_seq);
+    Py_XDECREF(py_envp_seq);
+    Py_XDECREF(py_cpus_seq);
+    Py_DECREF(py_rlimits_seq);
+    return Py_BuildValue("ii", pid, pidfd);
+
+error:
+    if (stack != NULL)
+        munmap(stack, PSUTIL_SPAWN_STACK_SIZE);
+    if (a.cpus != NULL)
+        CPU_FREE(a.cpus);
+    PyMem_Free(a.rlim_resources);
+    PyMem_Free(a.rlims);
+    PyMem_Free(a.argv);
+    PyMem_Free(a.envp);
+    Py_XDECREF(py_argv_seq);
+    Py_XDECREF(py_envp_seq);
+    Py_XDECREF(py_cpus_seq);
+    Py_XDECREF(py_rlimits_seq);
+    return NULL;
+}
+
+
 #if PSUTIL_HAVE_PRLIMIT
 /*
  * A wrapper around prlimit(2); sets process resource limits.
@@ -567,6 +1122,12 @@ PsutilMethods[] = {
      "Get process I/O priority"},
     {"proc_ioprio_set", psutil_proc_ioprio_set, METH_VARARGS,
      "Set process I/O priority"},
+#endif
+#if PSUTIL_HAVE_PIDFD
+    {"proc_pidfd_open", psutil_proc_pidfd_open, METH_VARARGS,
+     "Return a file descriptor referring to the process (pidfd)"},
+    {"proc_pidfd_send_signal", psutil_proc_pidfd_send_signal, METH_VARARGS,
+     "Send a signal to the process referred to by a pidfd"},
 #endif
     {"proc_cpu_affinity_get", psutil_proc_cpu_affinity_get, METH_VARARGS,
      "Return process CPU affinity as a Python long (the bitmask)."},
@@ -587,6 +1148,10 @@ PsutilMethods[] = {
 
     {"linux_sysinfo", psutil_linux_sysinfo, METH_VARARGS,
      "A wrapper around sysinfo(), return system memory usage statistics"},
+    {"proc_send_signal_many", psutil_proc_send_signal_many, METH_VARARGS,
+     "Send a signal to many processes, verifying their identity first"},
+    {"linux_spawn", psutil_linux_spawn, METH_VARARGS,
+     "Spawn a new process with limits applied before exec"},
 #if PSUTIL_HAVE_PRLIMIT
     {"linux_prlimit", psutil_linux_prlimit, METH_VARARGS,
      "Get or set process resource limits."},
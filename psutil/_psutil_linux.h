@@ -12,10 +12,14 @@ static PyObject* psutil_proc_cpu_affinity_get(PyObject* self, PyObject* args);
 static PyObject* psutil_proc_cpu_affinity_set(PyObject* self, PyObject* args);
 static PyObject* psutil_proc_ioprio_get(PyObject* self, PyObject* args);
 static PyObject* psutil_proc_ioprio_get(PyObject* self, PyObject* args);
+static PyObject* psutil_proc_pidfd_open(PyObject* self, PyObject* args);
+static PyObject* psutil_proc_pidfd_send_signal(PyObject* self, PyObject* args);
+static PyObject* psutil_proc_send_signal_many(PyObject* self, PyObject* args);
 
 // system
 
 static PyObject* psutil_disk_partitions(PyObject* self, PyObject* args);
+static PyObject* psutil_linux_spawn(PyObject* self, PyObject* args);
 static PyObject* psutil_linux_sysinfo(PyObject* self, PyObject* args);
 static PyObject* psutil_users(PyObject* self, PyObject* args);
 static PyObject* psutil_net_if_stats(PyObject* self, PyObject* args);
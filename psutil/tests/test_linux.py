@@ -13,6 +13,7 @@ import os
 import pprint
 import re
 import shutil
+import signal
 import socket
 import struct
 import tempfile
@@ -31,9 +32,12 @@ from psutil._compat import PY3
 from psutil._compat import u
 from psutil.tests import call_until
 from psutil.tests import get_kernel_version
+from psutil.tests import get_test_subprocess
+from psutil.tests import GLOBAL_TIMEOUT
 from psutil.tests import importlib
 from psutil.tests import MEMORY_TOLERANCE
 from psutil.tests import PYPY
+from psutil.tests import PYTHON
 from psutil.tests import pyrun
 from psutil.tests import reap_children
 from psutil.tests import retry_before_failing
@@ -882,6 +886,67 @@ class TestProcess(unittest.TestCase):
                 self.assertEqual(p.open_files(), [])
                 assert m.called
 
+    @unittest.skipUnless(hasattr(psutil._psplatform, "get_child_reaper"),
+                         "pidfd not supported")
+    def test_popen_reaper(self):
+        procs = [psutil.Popen([PYTHON, "-c", "import sys; sys.exit(3)"],
+                              reaper=True) for x in range(5)]
+        for proc in procs:
+            self.assertEqual(proc.wait(GLOBAL_TIMEOUT), 3)
+            self.assertEqual(proc.returncode, 3)
+            self.assertEqual(proc.poll(), 3)
+        proc = psutil.Popen([PYTHON, "-c", "import time; time.sleep(60)"],
+                            reaper=True)
+        self.addCleanup(reap_children)
+        self.assertRaises(psutil.TimeoutExpired, proc.wait, 0.01)
+        proc.kill()
+        # same as subprocess.Popen: negative signal number
+        self.assertEqual(proc.wait(GLOBAL_TIMEOUT), -9)
+
+    def test_spawn(self):
+        proc = psutil.spawn([PYTHON, "-c", "import sys; sys.exit(3)"])
+        self.assertEqual(proc.wait(GLOBAL_TIMEOUT), 3)
+        self.assertIsNone(proc._pidfd)
+        # limits are in place before the program starts
+        proc = psutil.spawn([PYTHON, "-c", "import time; time.sleep(60)"],
+                            cpu_affinity=[0], nice=5,
+                            rlimits={psutil.RLIMIT_NOFILE: (100, 100)},
+                            ionice=(psutil.IOPRIO_CLASS_IDLE, None))
+        self.addCleanup(reap_children)
+        self.assertEqual(proc.cpu_affinity(), [0])
+        self.assertEqual(proc.nice(), 5)
+        self.assertEqual(proc.rlimit(psutil.RLIMIT_NOFILE), (100, 100))
+        self.assertEqual(proc.ionice().ioclass, psutil.IOPRIO_CLASS_IDLE)
+        self.assertRaises(psutil.TimeoutExpired, proc.wait, 0.01)
+        proc.kill()
+        self.assertEqual(proc.wait(GLOBAL_TIMEOUT), 9)
+
+    def test_spawn_errors(self):
+        with self.assertRaises(OSError) as cm:
+            psutil.spawn([PYTHON, "-c", "pass"], cwd="/psutil-nonexistent")
+        self.assertEqual(cm.exception.errno, errno.ENOENT)
+        with self.assertRaises(OSError) as cm:
+            psutil.spawn(["/psutil-nonexistent"])
+        self.assertEqual(cm.exception.errno, errno.ENOENT)
+        self.assertRaises(ValueError, psutil.spawn, [PYTHON],
+                          ionice=(psutil.IOPRIO_CLASS_BE, 10))
+        self.assertRaises(ValueError, psutil.spawn, [])
+
+    def test_send_signal_many(self):
+        sproc = get_test_subprocess()
+        p = psutil.Process(sproc.pid)
+        # wrong create time == PID reused: the process is left alone
+        ret = psutil._pslinux.send_signal_many(
+            [(p.pid, p.create_time() - 10)], signal.SIGKILL)
+        self.assertEqual(ret, [errno.ESRCH])
+        self.assertTrue(p.is_running())
+        ret = psutil._pslinux.send_signal_many(
+            [(p.pid, p.create_time())], signal.SIGKILL)
+        self.assertEqual(ret, [0])
+        self.assertEqual(p.wait(GLOBAL_TIMEOUT), signal.SIGKILL)
+        self.assertRaises(ValueError, psutil._pslinux.send_signal_many,
+                          [(0, None)], signal.SIGKILL)
+
     # --- mocked tests
 
     def test_terminal_mocked(self):
@@ -1177,6 +1177,40 @@ class TestProcess(unittest.TestCase):
         self.assertEqual(children[0].ppid(), os.getpid())
         self.assertEqual(children[1].ppid(), children[0].pid)
 
+    def test_kill_tree(self):
+        # A (child) -> B (grandchild)
+        s = "import subprocess, os, sys, time;"
+        s += "PYTHON = os.path.realpath(sys.executable);"
+        s += "cmd = [PYTHON, '-c', 'import time; time.sleep(60);'];"
+        s += "subprocess.Popen(cmd);"
+        s += "time.sleep(60);"
+        child = psutil.Process(get_test_subprocess(cmd=[PYTHON, "-c", s]).pid)
+        stop_at = time.time() + GLOBAL_TIMEOUT
+        while time.time() < stop_at:
+            if child.children():
+                break
+        grandchild = child.children()[0]
+        l = []
+        gone, alive = child.kill_tree(timeout=GLOBAL_TIMEOUT,
+                                      callback=l.append)
+        self.assertEqual(alive, [])
+        self.assertEqual(set(gone), set([child, grandchild]))
+        self.assertEqual(set(l), set([child, grandchild]))
+        if POSIX:
+            self.assertEqual(child.returncode, signal.SIGKILL)
+        self.assertFalse(child.is_running())
+        self.assertFalse(grandchild.is_running())
+        self.assertRaises(psutil.NoSuchProcess, child.send_signal_tree,
+                          signal.SIGTERM)
+
+    def test_kill_tree_include_self(self):
+        sproc = get_test_subprocess()
+        p = psutil.Process(sproc.pid)
+        gone, alive = p.kill_tree(include_self=False)
+        self.assertEqual((gone, alive), ([], []))
+        self.assertTrue(p.is_running())
+        self.assertRaises(ValueError, p.kill_tree, timeout=-1)
+
     def test_children_duplicates(self):
         # find the process which has the highest number of children
         table = collections.defaultdict(int)